@@ -0,0 +1,77 @@
+#pragma once
+
+#include <charconv>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <mysql/mysql.h>
+
+// Read-only view over a fetched row. Fields are string_views into the result
+// buffer (sized via mysql_fetch_lengths), so nothing is copied until a value
+// is actually stored in an owned object.
+class RowView {
+public:
+  RowView(MYSQL_ROW row, unsigned long* lengths) : row(row), lengths(lengths) {}
+
+  std::string_view str(int i) const {
+    return row[i] ? std::string_view(row[i], lengths[i]) : std::string_view();
+  }
+  std::string text(int i) const {
+    std::string_view v = str(i);
+    return std::string(v.data(), v.size());
+  }
+  int toInt(int i) const {
+    int value = 0;
+    std::string_view v = str(i);
+    std::from_chars(v.data(), v.data() + v.size(), value);
+    return value;
+  }
+  double toDouble(int i) const {
+    double value = 0.0;
+    std::string_view v = str(i);
+    std::from_chars(v.data(), v.data() + v.size(), value);
+    return value;
+  }
+  template <typename T>
+  T as(int i) const {
+    if constexpr (std::is_same_v<T, int>) return toInt(i);
+    else if constexpr (std::is_same_v<T, double>) return toDouble(i);
+    else return text(i);
+  }
+
+private:
+  MYSQL_ROW row;
+  unsigned long* lengths;
+};
+
+// Typed decode of column Col from a row produced by Query (a schema::Select)
+template <typename Query, typename Col>
+typename Col::type field(const RowView& row) {
+  return row.as<typename Col::type>(Query::template at<Col>());
+}
+
+// Runs a query, calls onSize(rowCount) once before the first row so callers can
+// reserve, then onRow(const RowView&) for each row; returns false on error
+template <typename SizeFn, typename RowFn>
+bool forEachRow(MYSQL* conn, const std::string& query, SizeFn&& onSize, RowFn&& onRow) {
+  if (mysql_query(conn, query.c_str()) != 0) {
+    std::cout << "Query Error: " << mysql_error(conn) << std::endl;
+    return false;
+  }
+  MYSQL_RES* res = mysql_store_result(conn);
+  if (!res) return false;
+  onSize(static_cast<std::size_t>(mysql_num_rows(res)));
+  MYSQL_ROW row;
+  while ((row = mysql_fetch_row(res))) {
+    onRow(RowView(row, mysql_fetch_lengths(res)));
+  }
+  mysql_free_result(res);
+  return true;
+}
+
+template <typename RowFn>
+bool forEachRow(MYSQL* conn, const std::string& query, RowFn&& onRow) {
+  return forEachRow(conn, query, [](std::size_t) {}, std::forward<RowFn>(onRow));
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Table and column descriptions for bvp_student_office (see setup.sql).
+// Each column carries its table, SQL name and the C++ type it decodes to;
+// Select, Insert, Update and Where turn a column pack into SQL column lists and
+// result positions at compile time, so queries never depend on the table's
+// physical column order and cannot mix in another table's columns.
+namespace schema {
+
+// Base for column descriptions: the owning table and the decoded C++ type
+template <typename Table, typename T>
+struct Column {
+  using table = Table;
+  using type = T;
+};
+
+struct Admins {
+  static constexpr std::string_view name = "Admins";
+  struct AdminID    : Column<Admins, std::string> { static constexpr std::string_view name = "AdminID"; };
+  struct Name       : Column<Admins, std::string> { static constexpr std::string_view name = "Name"; };
+  struct Department : Column<Admins, std::string> { static constexpr std::string_view name = "Department"; };
+  struct Contact    : Column<Admins, std::string> { static constexpr std::string_view name = "Contact"; };
+  struct Password   : Column<Admins, std::string> { static constexpr std::string_view name = "Password"; };
+};
+
+struct Students {
+  static constexpr std::string_view name = "Students";
+  struct StudentID      : Column<Students, std::string> { static constexpr std::string_view name = "StudentID"; };
+  struct Name           : Column<Students, std::string> { static constexpr std::string_view name = "Name"; };
+  struct Department     : Column<Students, std::string> { static constexpr std::string_view name = "Department"; };
+  struct Year           : Column<Students, int> { static constexpr std::string_view name = "Year"; };
+  struct Contact        : Column<Students, std::string> { static constexpr std::string_view name = "Contact"; };
+  struct AcademicRecord : Column<Students, std::string> { static constexpr std::string_view name = "AcademicRecord"; };
+  struct FeeStatus      : Column<Students, std::string> { static constexpr std::string_view name = "FeeStatus"; };
+  struct Password       : Column<Students, std::string> { static constexpr std::string_view name = "Password"; };
+};
+
+struct Marksheets {
+  static constexpr std::string_view name = "Marksheets";
+  struct StudentID : Column<Marksheets, std::string> { static constexpr std::string_view name = "StudentID"; };
+  struct Subject   : Column<Marksheets, std::string> { static constexpr std::string_view name = "Subject"; };
+  struct Marks     : Column<Marksheets, int> { static constexpr std::string_view name = "Marks"; };
+  struct Grade     : Column<Marksheets, std::string> { static constexpr std::string_view name = "Grade"; };
+};
+
+struct FeeReceipts {
+  static constexpr std::string_view name = "FeeReceipts";
+  struct ReceiptID          : Column<FeeReceipts, std::string> { static constexpr std::string_view name = "ReceiptID"; };
+  struct StudentID          : Column<FeeReceipts, std::string> { static constexpr std::string_view name = "StudentID"; };
+  struct Amount             : Column<FeeReceipts, double> { static constexpr std::string_view name = "Amount"; };
+  struct PaidOn             : Column<FeeReceipts, std::string> { static constexpr std::string_view name = "PaidOn"; };
+  struct TransactionDetails : Column<FeeReceipts, std::string> { static constexpr std::string_view name = "TransactionDetails"; };
+  struct Status             : Column<FeeReceipts, std::string> { static constexpr std::string_view name = "Status"; };
+};
+
+// Materialized per-student aggregates, maintained from the write path
+struct StudentSummary {
+  static constexpr std::string_view name = "StudentSummary";
+  struct StudentID    : Column<StudentSummary, std::string> { static constexpr std::string_view name = "StudentID"; };
+  struct Department   : Column<StudentSummary, std::string> { static constexpr std::string_view name = "Department"; };
+  struct AvgMarks     : Column<StudentSummary, double> { static constexpr std::string_view name = "AvgMarks"; };
+  struct SubjectCount : Column<StudentSummary, int> { static constexpr std::string_view name = "SubjectCount"; };
+  struct GradeA       : Column<StudentSummary, int> { static constexpr std::string_view name = "GradeA"; };
+  struct GradeB       : Column<StudentSummary, int> { static constexpr std::string_view name = "GradeB"; };
+  struct GradeC       : Column<StudentSummary, int> { static constexpr std::string_view name = "GradeC"; };
+  struct GradeD       : Column<StudentSummary, int> { static constexpr std::string_view name = "GradeD"; };
+  struct GradeF       : Column<StudentSummary, int> { static constexpr std::string_view name = "GradeF"; };
+  struct TotalPaid    : Column<StudentSummary, double> { static constexpr std::string_view name = "TotalPaid"; };
+  struct LastPaidOn   : Column<StudentSummary, std::string> { static constexpr std::string_view name = "LastPaidOn"; };
+  struct DeptRank     : Column<StudentSummary, int> { static constexpr std::string_view name = "DeptRank"; };
+};
+
+namespace detail {
+
+template <typename... Cols>
+constexpr std::size_t joinedLength() {
+  return ((Cols::name.size() + 2) + ... + 0) - 2;
+}
+
+// "A, B, C" as a null-terminated char array built by the compiler
+template <typename... Cols>
+constexpr std::array<char, joinedLength<Cols...>() + 1> joinNames() {
+  std::array<char, joinedLength<Cols...>() + 1> out{};
+  std::size_t pos = 0;
+  for (std::string_view col : {Cols::name...}) {
+    if (pos != 0) {
+      out[pos++] = ',';
+      out[pos++] = ' ';
+    }
+    for (char c : col) out[pos++] = c;
+  }
+  return out;
+}
+
+template <typename Table, typename... Cols>
+constexpr bool allColumnsOf = (std::is_same_v<typename Cols::table, Table> && ...);
+
+template <typename Col, typename... Cols>
+constexpr int indexOf() {
+  constexpr bool matches[] = {std::is_same_v<Col, Cols>...};
+  for (std::size_t i = 0; i < sizeof...(Cols); ++i) {
+    if (matches[i]) return static_cast<int>(i);
+  }
+  return -1;
+}
+
+}  // namespace detail
+
+template <typename... Cols>
+struct ColumnList {
+  static_assert(sizeof...(Cols) > 0, "a column list needs at least one column");
+
+  static constexpr std::size_t size = sizeof...(Cols);
+  static constexpr std::array<std::string_view, sizeof...(Cols)> names{{Cols::name...}};
+  static constexpr auto storage = detail::joinNames<Cols...>();
+  static constexpr std::string_view value{storage.data(), detail::joinedLength<Cols...>()};
+
+  // Position of Col in the list; fails to compile if Col is not part of it
+  template <typename Col>
+  static constexpr int at() {
+    constexpr int index = detail::indexOf<Col, Cols...>();
+    static_assert(index >= 0, "column is not part of this column list");
+    return index;
+  }
+};
+
+// SELECT <Cols...> FROM <Table> [WHERE ...]
+template <typename Table, typename... Cols>
+struct Select : ColumnList<Cols...> {
+  static_assert(detail::allColumnsOf<Table, Cols...>, "selected column belongs to another table");
+
+  static std::string sql(const std::string& where = "") {
+    std::string query = "SELECT ";
+    query.append(ColumnList<Cols...>::value);
+    query.append(" FROM ");
+    query.append(Table::name);
+    if (!where.empty()) query.append(" WHERE ").append(where);
+    return query;
+  }
+};
+
+// INSERT INTO <Table> (<Cols...>) VALUES ; the caller appends the value tuple.
+// into() stops before VALUES for INSERT ... SELECT.
+template <typename Table, typename... Cols>
+struct Insert : ColumnList<Cols...> {
+  static_assert(detail::allColumnsOf<Table, Cols...>, "inserted column belongs to another table");
+
+  static std::string into() {
+    std::string query = "INSERT INTO ";
+    query.append(Table::name);
+    query.append(" (");
+    query.append(ColumnList<Cols...>::value);
+    query.append(") ");
+    return query;
+  }
+  static std::string sql() { return into() + "VALUES "; }
+};
+
+// UPDATE <Table> SET <Col>=<literal>, ... [WHERE ...]; literals are already
+// escaped SQL values in column order
+template <typename Table, typename... Cols>
+struct Update : ColumnList<Cols...> {
+  static_assert(detail::allColumnsOf<Table, Cols...>, "updated column belongs to another table");
+
+  static std::string sql(const std::array<std::string, sizeof...(Cols)>& literals, const std::string& where = "") {
+    std::string query = "UPDATE ";
+    query.append(Table::name);
+    query.append(" SET ");
+    for (std::size_t i = 0; i < literals.size(); ++i) {
+      if (i != 0) query.append(", ");
+      query.append(ColumnList<Cols...>::names[i]).append("=").append(literals[i]);
+    }
+    if (!where.empty()) query.append(" WHERE ").append(where);
+    return query;
+  }
+};
+
+// DELETE FROM <Table> WHERE ...
+template <typename Table>
+struct Delete {
+  static std::string sql(const std::string& where) {
+    std::string query = "DELETE FROM ";
+    query.append(Table::name);
+    query.append(" WHERE ").append(where);
+    return query;
+  }
+};
+
+// <Col>=<literal> AND ... over columns of a single table
+template <typename Col, typename... Cols>
+struct Where : ColumnList<Col, Cols...> {
+  static_assert(detail::allColumnsOf<typename Col::table, Cols...>, "where columns belong to different tables");
+
+  static std::string sql(const std::array<std::string, 1 + sizeof...(Cols)>& literals) {
+    std::string clause;
+    for (std::size_t i = 0; i < literals.size(); ++i) {
+      if (i != 0) clause.append(" AND ");
+      clause.append(ColumnList<Col, Cols...>::names[i]).append("=").append(literals[i]);
+    }
+    return clause;
+  }
+};
+
+}  // namespace schema
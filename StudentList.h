@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <mysql/mysql.h>
+
+#include "RowView.h"
+#include "Schema.h"
+
+// Every student with marks and receipts, as loaded for the admin listings.
+// All strings and vectors are allocated from the list's own arena, so a load
+// costs a few heap allocations for arena blocks instead of several per row,
+// and the whole result is released at once when the list goes away.
+struct MarkEntry {
+  explicit MarkEntry(std::pmr::memory_resource* mr) : subject(mr), grade(mr) {}
+
+  std::pmr::string subject;
+  int marks = 0;
+  std::pmr::string grade;
+};
+
+struct ReceiptEntry {
+  explicit ReceiptEntry(std::pmr::memory_resource* mr) : receiptID(mr), paidOn(mr), details(mr), status(mr) {}
+
+  std::pmr::string receiptID;
+  double amount = 0.0;
+  std::pmr::string paidOn, details, status;
+};
+
+struct StudentEntry {
+  explicit StudentEntry(std::pmr::memory_resource* mr)
+      : studentID(mr), name(mr), department(mr), contact(mr), feeStatus(mr), marks(mr), receipts(mr) {}
+
+  std::pmr::string studentID, name, department, contact, feeStatus;
+  int year = 0;
+  std::pmr::vector<MarkEntry> marks;
+  std::pmr::vector<ReceiptEntry> receipts;
+};
+
+struct StudentList {
+  // Declared first so it outlives the rows allocated from it; heap-held so a
+  // moved list keeps pointing at the same arena
+  std::unique_ptr<std::pmr::monotonic_buffer_resource> arena = std::make_unique<std::pmr::monotonic_buffer_resource>();
+  std::pmr::vector<StudentEntry> students{arena.get()};
+};
+
+// field() for string columns, copied into an arena-backed string
+template <typename Query, typename Col>
+void assignField(std::pmr::string& out, const RowView& row) {
+  out.assign(row.str(Query::template at<Col>()));
+}
+
+// Loads students, then all marks and all receipts in one query each, matched by
+// StudentID. Returns false if any query fails; list then holds whatever was
+// loaded before the failure.
+inline bool loadAllStudents(MYSQL* conn, StudentList& list) {
+  using Students = schema::Students;
+  using Marks = schema::Marksheets;
+  using Receipts = schema::FeeReceipts;
+  using ListQuery = schema::Select<Students, Students::StudentID, Students::Name, Students::Department,
+                                   Students::Year, Students::Contact, Students::FeeStatus>;
+  using MarksQuery = schema::Select<Marks, Marks::StudentID, Marks::Subject, Marks::Marks, Marks::Grade>;
+  using ReceiptsQuery = schema::Select<Receipts, Receipts::StudentID, Receipts::ReceiptID, Receipts::Amount,
+                                       Receipts::PaidOn, Receipts::TransactionDetails, Receipts::Status>;
+
+  std::pmr::memory_resource* mr = list.arena.get();
+  auto& students = list.students;
+  bool ok = forEachRow(conn, ListQuery::sql(), [&](std::size_t rows) { students.reserve(rows); },
+                       [&](const RowView& row) {
+    using Q = ListQuery;
+    StudentEntry& s = students.emplace_back(mr);
+    assignField<Q, Students::StudentID>(s.studentID, row);
+    assignField<Q, Students::Name>(s.name, row);
+    assignField<Q, Students::Department>(s.department, row);
+    s.year = field<Q, Students::Year>(row);
+    assignField<Q, Students::Contact>(s.contact, row);
+    assignField<Q, Students::FeeStatus>(s.feeStatus, row);
+  });
+  if (!ok) return false;
+  if (students.empty()) return true;
+
+  // Keys view the StudentIDs above; students was reserved up front, so they
+  // never move while the map is in use
+  std::pmr::unordered_map<std::string_view, std::size_t> indexByID(mr);
+  indexByID.reserve(students.size());
+  for (std::size_t i = 0; i < students.size(); ++i) {
+    indexByID.emplace(students[i].studentID, i);
+  }
+
+  ok = forEachRow(conn, MarksQuery::sql(), [&](const RowView& row) {
+    using Q = MarksQuery;
+    auto it = indexByID.find(row.str(Q::at<Marks::StudentID>()));
+    if (it == indexByID.end()) return;
+    MarkEntry& m = students[it->second].marks.emplace_back(mr);
+    assignField<Q, Marks::Subject>(m.subject, row);
+    m.marks = field<Q, Marks::Marks>(row);
+    assignField<Q, Marks::Grade>(m.grade, row);
+  });
+  if (!ok) return false;
+
+  return forEachRow(conn, ReceiptsQuery::sql(), [&](const RowView& row) {
+    using Q = ReceiptsQuery;
+    auto it = indexByID.find(row.str(Q::at<Receipts::StudentID>()));
+    if (it == indexByID.end()) return;
+    ReceiptEntry& r = students[it->second].receipts.emplace_back(mr);
+    assignField<Q, Receipts::ReceiptID>(r.receiptID, row);
+    r.amount = field<Q, Receipts::Amount>(row);
+    assignField<Q, Receipts::PaidOn>(r.paidOn, row);
+    assignField<Q, Receipts::TransactionDetails>(r.details, row);
+    assignField<Q, Receipts::Status>(r.status, row);
+  });
+}
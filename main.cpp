@@ -5,12 +5,21 @@
 #include <sstream>
 #include <tuple>
 #include <limits>
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <string_view>
 #include <mysql/mysql.h>
 
 // Qt headers for GUI login
 #include <QApplication>
 #include "LoginDialog.h"
 
+// Compile-time table/column metadata, row decoding and the bulk student loader
+#include "Schema.h"
+#include "RowView.h"
+#include "StudentList.h"
+
 using namespace std;
 
 #define HOST "localhost"
@@ -32,6 +41,117 @@ string escapeString(MYSQL* conn, const string& str) {
     return result;
 }
 
+// SQL literals for the values bound by schema::Insert/Update/Where
+string sqlValue(MYSQL* conn, const string& value) { return "'" + escapeString(conn, value) + "'"; }
+string sqlValue(MYSQL*, int value) { return to_string(value); }
+string sqlValue(MYSQL*, double value) { return to_string(value); }
+
+template <typename Query, typename... Values>
+string insertQuery(MYSQL* conn, const Values&... values) {
+    static_assert(sizeof...(Values) == Query::size, "value count must match the insert column list");
+    string query = Query::sql() + "(";
+    bool first = true;
+    ((query += (first ? "" : ", ") + sqlValue(conn, values), first = false), ...);
+    return query + ")";
+}
+
+template <typename Query, typename... Values>
+string updateQuery(MYSQL* conn, const string& where, const Values&... values) {
+    static_assert(sizeof...(Values) == Query::size, "value count must match the update column list");
+    return Query::sql({sqlValue(conn, values)...}, where);
+}
+
+// Column name from schema metadata, optionally qualified with a table alias
+template <typename Col>
+string columnName(const string& alias = "") {
+    return (alias.empty() ? "" : alias + ".") + string(Col::name);
+}
+
+// "<Col>=<value>" as an SQL expression (e.g. inside SUM()), value escaped
+template <typename Col, typename Value>
+string columnEquals(MYSQL* conn, const Value& value, const string& alias = "") {
+    return columnName<Col>(alias) + "=" + sqlValue(conn, value);
+}
+
+// Fills an SQL template: {Table} and {Table.Column} become the schema names of
+// the listed Cols and their tables; any other {key} is taken from `fragments`,
+// which must already be valid (escaped) SQL
+template <typename... Cols>
+string expandSql(const string& text, const vector<pair<string, string>>& fragments = {}) {
+    vector<pair<string, string>> values = fragments;
+    ((values.emplace_back(string(Cols::table::name), string(Cols::table::name)),
+      values.emplace_back(string(Cols::table::name) + "." + string(Cols::name), string(Cols::name))), ...);
+    string out;
+    size_t pos = 0;
+    for (size_t open = text.find('{'); open != string::npos; open = text.find('{', pos)) {
+        size_t close = text.find('}', open);
+        assert(close != string::npos && "unterminated placeholder in SQL template");
+        string key = text.substr(open + 1, close - open - 1);
+        auto it = find_if(values.begin(), values.end(), [&](const auto& v) { return v.first == key; });
+        assert(it != values.end() && "unknown placeholder in SQL template");
+        out.append(text, pos, open - pos).append(it->second);
+        pos = close + 1;
+    }
+    return out.append(text, pos, string::npos);
+}
+
+// "<Col>=<value> AND ..." with each value escaped
+template <typename... Cols, typename... Values>
+string whereEquals(MYSQL* conn, const Values&... values) {
+    static_assert(sizeof...(Values) == sizeof...(Cols), "value count must match the where column list");
+    return schema::Where<Cols...>::sql({sqlValue(conn, values)...});
+}
+
+// Table metadata (Schema.h) and the column sets each consumer actually reads;
+// positions are resolved at compile time
+using StudentsTable = schema::Students;
+using MarksTable = schema::Marksheets;
+using ReceiptsTable = schema::FeeReceipts;
+using AdminsTable = schema::Admins;
+using SummaryTable = schema::StudentSummary;
+using AdminLoginQuery = schema::Select<AdminsTable, AdminsTable::AdminID>;
+using StudentLoginQuery = schema::Select<StudentsTable, StudentsTable::StudentID>;
+using StudentProfileQuery = schema::Select<StudentsTable, StudentsTable::StudentID, StudentsTable::Name,
+                                           StudentsTable::Department, StudentsTable::Year, StudentsTable::Contact,
+                                           StudentsTable::AcademicRecord, StudentsTable::FeeStatus>;
+using MarksheetQuery = schema::Select<MarksTable, MarksTable::Subject, MarksTable::Marks, MarksTable::Grade>;
+using ReceiptQuery = schema::Select<ReceiptsTable, ReceiptsTable::ReceiptID, ReceiptsTable::Amount,
+                                    ReceiptsTable::PaidOn, ReceiptsTable::TransactionDetails, ReceiptsTable::Status>;
+using MarkExistsQuery = schema::Select<MarksTable, MarksTable::Subject>;
+using StudentInsert = schema::Insert<StudentsTable, StudentsTable::StudentID, StudentsTable::Name,
+                                     StudentsTable::Department, StudentsTable::Year, StudentsTable::Contact,
+                                     StudentsTable::AcademicRecord, StudentsTable::FeeStatus, StudentsTable::Password>;
+using MarksInsert = schema::Insert<MarksTable, MarksTable::StudentID, MarksTable::Subject, MarksTable::Marks,
+                                   MarksTable::Grade>;
+using StudentUpdate = schema::Update<StudentsTable, StudentsTable::Name, StudentsTable::Department,
+                                     StudentsTable::Year, StudentsTable::Contact, StudentsTable::AcademicRecord,
+                                     StudentsTable::FeeStatus>;
+using FeeStatusUpdate = schema::Update<StudentsTable, StudentsTable::FeeStatus>;
+using MarksUpdate = schema::Update<MarksTable, MarksTable::Marks, MarksTable::Grade>;
+using ReceiptInsert = schema::Insert<ReceiptsTable, ReceiptsTable::ReceiptID, ReceiptsTable::StudentID,
+                                     ReceiptsTable::Amount, ReceiptsTable::PaidOn, ReceiptsTable::TransactionDetails,
+                                     ReceiptsTable::Status>;
+using SummaryInsert = schema::Insert<SummaryTable, SummaryTable::StudentID, SummaryTable::Department,
+                                     SummaryTable::AvgMarks, SummaryTable::SubjectCount, SummaryTable::GradeA,
+                                     SummaryTable::GradeB, SummaryTable::GradeC, SummaryTable::GradeD,
+                                     SummaryTable::GradeF, SummaryTable::TotalPaid, SummaryTable::LastPaidOn>;
+using SummaryDepartmentQuery = schema::Select<SummaryTable, SummaryTable::Department>;
+using SummarySourceQuery = schema::Select<StudentsTable, StudentsTable::StudentID, StudentsTable::Department>;
+using RankingQuery = schema::Select<SummaryTable, SummaryTable::StudentID, SummaryTable::Department,
+                                    SummaryTable::DeptRank, SummaryTable::AvgMarks, SummaryTable::SubjectCount,
+                                    SummaryTable::GradeA, SummaryTable::GradeB, SummaryTable::GradeC,
+                                    SummaryTable::GradeD, SummaryTable::GradeF, SummaryTable::TotalPaid,
+                                    SummaryTable::LastPaidOn>;
+
+// Per-student aggregates as stored in the StudentSummary table
+class StudentSummary {
+public:
+    string studentID, department, lastPaidOn;
+    double avgMarks = 0.0, totalPaid = 0.0;
+    int subjectCount = 0, deptRank = 0;
+    int gradeCounts[5] = {0, 0, 0, 0, 0};  // A, B, C, D, F
+};
+
 // Student class (Extended with marks and receipts)
 class Student {
 public:
@@ -55,6 +175,8 @@ public:
     void deleteStudent(DBManager& db, string studentID);
     void updateMarks(DBManager& db, string studentID);
     void addFeeReceipt(DBManager& db, string studentID);
+    void viewClassRankings(DBManager& db);
+    void rebuildSummaries(DBManager& db);
 };
 
 // Database Manager (Improved with escaping and new methods)
@@ -65,10 +187,17 @@ public:
     ~DBManager();
     bool login(string userType, string id, string password);
     Student getStudent(string studentID);
-    vector<Student> getAllStudents();
+    bool getAllStudents(StudentList& list);  // false if any of the queries failed
     bool executeQuery(const string& query);  // For INSERT/UPDATE/DELETE
+    bool runInTransaction(const function<bool()>& work);  // Commits if work() succeeds, else rolls back
     vector<pair<string, pair<int, string>>> getMarksheet(string studentID);
     vector<tuple<string, double, string, string, string>> getFeeReceipts(string studentID);
+    // StudentSummary maintenance (call in the same transaction as the underlying write)
+    bool refreshStudentSummary(const string& studentID);
+    bool rankDepartment(const string& department);  // Empty department re-ranks every department
+    bool rebuildStudentSummaries();
+    bool ensureStudentSummaries();  // Rebuilds if any student has no summary row yet
+    vector<StudentSummary> getClassRankings(const string& department);
 };
 
 DBManager::DBManager() {
@@ -90,13 +219,9 @@ DBManager::~DBManager() {
 }
 
 bool DBManager::login(string userType, string id, string password) {
-    string table = (userType == "admin") ? "Admins" : "Students";
-    string idField = (userType == "admin") ? "AdminID" : "StudentID";
-    string passField = "Password";  // Both tables have it now
-    string escapedId = escapeString(conn, id);
-    string escapedPass = escapeString(conn, password);
-    string query = "SELECT * FROM " + table + " WHERE " + idField + "='" + escapedId + 
-                   "' AND " + passField + "='" + escapedPass + "'";
+    string query = (userType == "admin")
+        ? AdminLoginQuery::sql(whereEquals<AdminsTable::AdminID, AdminsTable::Password>(conn, id, password))
+        : StudentLoginQuery::sql(whereEquals<StudentsTable::StudentID, StudentsTable::Password>(conn, id, password));
     if (mysql_query(conn, query.c_str()) != 0) {
         cout << "Query Error: " << mysql_error(conn) << endl;
         return false;
@@ -109,55 +234,26 @@ bool DBManager::login(string userType, string id, string password) {
 
 Student DBManager::getStudent(string studentID) {
     Student s;
-    string escapedID = escapeString(conn, studentID);
-    string query = "SELECT * FROM Students WHERE StudentID='" + escapedID + "'";
-    if (mysql_query(conn, query.c_str()) != 0) {
-        cout << "Query Error: " << mysql_error(conn) << endl;
-        return s;
-    }
-    MYSQL_RES* res = mysql_store_result(conn);
-    MYSQL_ROW row = mysql_fetch_row(res);
-    if (row) {
-        s.studentID = row[0] ? row[0] : "";
-        s.name = row[1] ? row[1] : "";
-        s.department = row[2] ? row[2] : "";
-        s.year = row[3] ? atoi(row[3]) : 0;
-        s.contact = row[4] ? row[4] : "";
-        s.academicRecord = row[5] ? row[5] : "";
-        s.feeStatus = row[6] ? row[6] : "";
-        s.password = row[7] ? row[7] : "";  // Password column (index 7)
-    }
-    if (res) mysql_free_result(res);
+    string query = StudentProfileQuery::sql(whereEquals<StudentsTable::StudentID>(conn, studentID));
+    bool ok = forEachRow(conn, query, [&](const RowView& row) {
+        using Q = StudentProfileQuery;
+        s.studentID = field<Q, StudentsTable::StudentID>(row);
+        s.name = field<Q, StudentsTable::Name>(row);
+        s.department = field<Q, StudentsTable::Department>(row);
+        s.year = field<Q, StudentsTable::Year>(row);
+        s.contact = field<Q, StudentsTable::Contact>(row);
+        s.academicRecord = field<Q, StudentsTable::AcademicRecord>(row);
+        s.feeStatus = field<Q, StudentsTable::FeeStatus>(row);
+    });
+    if (!ok) return s;
     // Fetch marks and receipts
     s.marks = getMarksheet(studentID);
     s.receipts = getFeeReceipts(studentID);
     return s;
 }
 
-vector<Student> DBManager::getAllStudents() {
-    vector<Student> students;
-    string query = "SELECT * FROM Students";
-    if (mysql_query(conn, query.c_str()) != 0) {
-        cout << "Query Error: " << mysql_error(conn) << endl;
-        return students;
-    }
-    MYSQL_RES* res = mysql_store_result(conn);
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(res))) {
-        Student s;
-        s.studentID = row[0] ? row[0] : "";
-        s.name = row[1] ? row[1] : "";
-        s.department = row[2] ? row[2] : "";
-        s.year = row[3] ? atoi(row[3]) : 0;
-        s.contact = row[4] ? row[4] : "";
-        s.academicRecord = row[5] ? row[5] : "";
-        s.feeStatus = row[6] ? row[6] : "";
-        s.marks = getMarksheet(s.studentID);
-        s.receipts = getFeeReceipts(s.studentID);
-        students.push_back(s);
-    }
-    if (res) mysql_free_result(res);
-    return students;
+bool DBManager::getAllStudents(StudentList& list) {
+    return loadAllStudents(conn, list);
 }
 
 bool DBManager::executeQuery(const string& query) {
@@ -168,42 +264,168 @@ bool DBManager::executeQuery(const string& query) {
     return true;
 }
 
+bool DBManager::runInTransaction(const function<bool()>& work) {
+    if (!executeQuery("START TRANSACTION")) return false;
+    if (work() && executeQuery("COMMIT")) return true;
+    executeQuery("ROLLBACK");
+    return false;
+}
+
 vector<pair<string, pair<int, string>>> DBManager::getMarksheet(string studentID) {
     vector<pair<string, pair<int, string>>> marks;
-    string escapedID = escapeString(conn, studentID);
-    string query = "SELECT Subject, Marks, Grade FROM Marksheets WHERE StudentID='" + escapedID + "'";
-    if (mysql_query(conn, query.c_str()) != 0) return marks;
-    MYSQL_RES* res = mysql_store_result(conn);
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(res))) {
-        string subject = row[0] ? row[0] : "";
-        int marksInt = row[1] ? atoi(row[1]) : 0;
-        string grade = row[2] ? row[2] : "";
-        marks.push_back({subject, {marksInt, grade}});
-    }
-    if (res) mysql_free_result(res);
+    string query = MarksheetQuery::sql(whereEquals<MarksTable::StudentID>(conn, studentID));
+    forEachRow(conn, query, [&](size_t rows) { marks.reserve(rows); }, [&](const RowView& row) {
+        using Q = MarksheetQuery;
+        marks.emplace_back(field<Q, MarksTable::Subject>(row),
+                           make_pair(field<Q, MarksTable::Marks>(row), field<Q, MarksTable::Grade>(row)));
+    });
     return marks;
 }
 
 vector<tuple<string, double, string, string, string>> DBManager::getFeeReceipts(string studentID) {
     vector<tuple<string, double, string, string, string>> receipts;
-    string escapedID = escapeString(conn, studentID);
-    string query = "SELECT ReceiptID, Amount, PaidOn, TransactionDetails, Status FROM FeeReceipts WHERE StudentID='" + escapedID + "'";
-    if (mysql_query(conn, query.c_str()) != 0) return receipts;
-    MYSQL_RES* res = mysql_store_result(conn);
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(res))) {
-        string id = row[0] ? row[0] : "";
-        double amount = row[1] ? atof(row[1]) : 0.0;
-        string date = row[2] ? row[2] : "";
-        string details = row[3] ? row[3] : "";
-        string status = row[4] ? row[4] : "";
-        receipts.push_back(make_tuple(id, amount, date, details, status));
-    }
-    if (res) mysql_free_result(res);
+    string query = ReceiptQuery::sql(whereEquals<ReceiptsTable::StudentID>(conn, studentID));
+    forEachRow(conn, query, [&](size_t rows) { receipts.reserve(rows); }, [&](const RowView& row) {
+        using Q = ReceiptQuery;
+        receipts.emplace_back(field<Q, ReceiptsTable::ReceiptID>(row), field<Q, ReceiptsTable::Amount>(row),
+                              field<Q, ReceiptsTable::PaidOn>(row), field<Q, ReceiptsTable::TransactionDetails>(row),
+                              field<Q, ReceiptsTable::Status>(row));
+    });
     return receipts;
 }
 
+// Recomputes StudentSummary rows from Marksheets/FeeReceipts; an empty studentID covers every student.
+// The derived tables name their columns after StudentSummary's, so the upsert reads them as src.<column>.
+string summaryUpsertQuery(MYSQL* conn, const string& studentID) {
+    bool oneStudent = !studentID.empty();
+    vector<pair<string, string>> fragments = {
+        {"studentFilter", oneStudent ? " WHERE " + columnEquals<StudentsTable::StudentID>(conn, studentID, "s") : ""},
+        {"marksFilter", oneStudent ? " WHERE " + columnEquals<MarksTable::StudentID>(conn, studentID) : ""},
+        {"receiptsFilter", oneStudent ? " AND " + columnEquals<ReceiptsTable::StudentID>(conn, studentID) : ""},
+        {"isPaid", columnEquals<ReceiptsTable::Status>(conn, "Paid")},
+        {"isA", columnEquals<MarksTable::Grade>(conn, "A")},
+        {"isB", columnEquals<MarksTable::Grade>(conn, "B")},
+        {"isC", columnEquals<MarksTable::Grade>(conn, "C")},
+        {"isD", columnEquals<MarksTable::Grade>(conn, "D")},
+        {"isF", columnEquals<MarksTable::Grade>(conn, "F")},
+    };
+    auto sql = [&](const string& text) {
+        return expandSql<StudentsTable::StudentID, StudentsTable::Department,
+                         MarksTable::StudentID, MarksTable::Marks,
+                         ReceiptsTable::StudentID, ReceiptsTable::Amount, ReceiptsTable::PaidOn,
+                         SummaryTable::StudentID, SummaryTable::Department, SummaryTable::AvgMarks,
+                         SummaryTable::SubjectCount, SummaryTable::GradeA, SummaryTable::GradeB, SummaryTable::GradeC,
+                         SummaryTable::GradeD, SummaryTable::GradeF, SummaryTable::TotalPaid,
+                         SummaryTable::LastPaidOn>(text, fragments);
+    };
+
+    fragments.emplace_back("marks", sql(
+        "SELECT {Marksheets.StudentID}, AVG({Marksheets.Marks}) AS {StudentSummary.AvgMarks}, "
+        "COUNT(*) AS {StudentSummary.SubjectCount}, "
+        "SUM({isA}) AS {StudentSummary.GradeA}, SUM({isB}) AS {StudentSummary.GradeB}, "
+        "SUM({isC}) AS {StudentSummary.GradeC}, SUM({isD}) AS {StudentSummary.GradeD}, "
+        "SUM({isF}) AS {StudentSummary.GradeF} "
+        "FROM {Marksheets}{marksFilter} GROUP BY {Marksheets.StudentID}"));
+
+    fragments.emplace_back("payments", sql(
+        "SELECT {FeeReceipts.StudentID}, SUM({FeeReceipts.Amount}) AS {StudentSummary.TotalPaid}, "
+        "MAX({FeeReceipts.PaidOn}) AS {StudentSummary.LastPaidOn} "
+        "FROM {FeeReceipts} WHERE {isPaid}{receiptsFilter} GROUP BY {FeeReceipts.StudentID}"));
+
+    string source = sql(
+        "SELECT s.{Students.StudentID} AS {StudentSummary.StudentID}, "
+        "s.{Students.Department} AS {StudentSummary.Department}, "
+        "COALESCE(m.{StudentSummary.AvgMarks}, 0) AS {StudentSummary.AvgMarks}, "
+        "COALESCE(m.{StudentSummary.SubjectCount}, 0) AS {StudentSummary.SubjectCount}, "
+        "COALESCE(m.{StudentSummary.GradeA}, 0) AS {StudentSummary.GradeA}, "
+        "COALESCE(m.{StudentSummary.GradeB}, 0) AS {StudentSummary.GradeB}, "
+        "COALESCE(m.{StudentSummary.GradeC}, 0) AS {StudentSummary.GradeC}, "
+        "COALESCE(m.{StudentSummary.GradeD}, 0) AS {StudentSummary.GradeD}, "
+        "COALESCE(m.{StudentSummary.GradeF}, 0) AS {StudentSummary.GradeF}, "
+        "COALESCE(f.{StudentSummary.TotalPaid}, 0) AS {StudentSummary.TotalPaid}, "
+        "f.{StudentSummary.LastPaidOn} AS {StudentSummary.LastPaidOn} "
+        "FROM {Students} s "
+        "LEFT JOIN ({marks}) m ON m.{Marksheets.StudentID} = s.{Students.StudentID} "
+        "LEFT JOIN ({payments}) f ON f.{FeeReceipts.StudentID} = s.{Students.StudentID}"
+        "{studentFilter}");
+
+    string updates;
+    for (size_t i = 1; i < SummaryInsert::size; ++i) {  // Every column but the StudentID key
+        string column(SummaryInsert::names[i]);
+        updates += (i == 1 ? "" : ", ") + column + " = src." + column;
+    }
+    return SummaryInsert::into() + "SELECT " + string(SummaryInsert::value) + " FROM (" + source + ") AS src " +
+           "ON DUPLICATE KEY UPDATE " + updates;
+}
+
+bool DBManager::refreshStudentSummary(const string& studentID) {
+    if (!executeQuery(summaryUpsertQuery(conn, studentID))) return false;
+    string department;
+    string query = SummaryDepartmentQuery::sql(whereEquals<SummaryTable::StudentID>(conn, studentID));
+    bool ok = forEachRow(conn, query, [&](const RowView& row) {
+        department = field<SummaryDepartmentQuery, SummaryTable::Department>(row);
+    });
+    return ok && (department.empty() || rankDepartment(department));
+}
+
+bool DBManager::rankDepartment(const string& department) {
+    string filter = department.empty() ? "" : " WHERE " + columnEquals<SummaryTable::Department>(conn, department);
+    return executeQuery(expandSql<SummaryTable::StudentID, SummaryTable::Department, SummaryTable::AvgMarks,
+                                  SummaryTable::DeptRank>(
+        "UPDATE {StudentSummary} ss JOIN ("
+        "SELECT {StudentSummary.StudentID}, RANK() OVER (PARTITION BY {StudentSummary.Department} "
+        "ORDER BY {StudentSummary.AvgMarks} DESC) AS {StudentSummary.DeptRank} FROM {StudentSummary}{filter}"
+        ") ranked ON ranked.{StudentSummary.StudentID} = ss.{StudentSummary.StudentID} "
+        "SET ss.{StudentSummary.DeptRank} = ranked.{StudentSummary.DeptRank}",
+        {{"filter", filter}}));
+}
+
+// Drops orphaned rows, recomputes every row and re-ranks, all in one transaction
+// so a failure leaves the previous summaries in place
+bool DBManager::rebuildStudentSummaries() {
+    string orphans = schema::Delete<SummaryTable>::sql(
+        columnName<SummaryTable::StudentID>() + " NOT IN (" +
+        schema::Select<StudentsTable, StudentsTable::StudentID>::sql() + ")");
+    return runInTransaction([&] {
+        return executeQuery(orphans) && executeQuery(summaryUpsertQuery(conn, "")) && rankDepartment("");
+    });
+}
+
+// Fresh installs and databases created before StudentSummary existed have
+// students without a summary row; fill them in before anything reads the table
+bool DBManager::ensureStudentSummaries() {
+    string missing = schema::Select<StudentsTable, StudentsTable::StudentID>::sql(
+        columnName<StudentsTable::StudentID>() + " NOT IN (" +
+        schema::Select<SummaryTable, SummaryTable::StudentID>::sql() + ")") + " LIMIT 1";
+    bool anyMissing = false;
+    if (!forEachRow(conn, missing, [&](size_t rows) { anyMissing = rows > 0; }, [](const RowView&) {})) return false;
+    return !anyMissing || rebuildStudentSummaries();
+}
+
+vector<StudentSummary> DBManager::getClassRankings(const string& department) {
+    vector<StudentSummary> rankings;
+    string where = department.empty() ? "" : whereEquals<SummaryTable::Department>(conn, department);
+    string query = RankingQuery::sql(where) + " ORDER BY " +
+                   string(schema::ColumnList<SummaryTable::Department, SummaryTable::DeptRank>::value);
+    forEachRow(conn, query, [&](size_t rows) { rankings.reserve(rows); }, [&](const RowView& row) {
+        using Q = RankingQuery;
+        StudentSummary& r = rankings.emplace_back();
+        r.studentID = field<Q, SummaryTable::StudentID>(row);
+        r.department = field<Q, SummaryTable::Department>(row);
+        r.deptRank = field<Q, SummaryTable::DeptRank>(row);
+        r.avgMarks = field<Q, SummaryTable::AvgMarks>(row);
+        r.subjectCount = field<Q, SummaryTable::SubjectCount>(row);
+        r.gradeCounts[0] = field<Q, SummaryTable::GradeA>(row);
+        r.gradeCounts[1] = field<Q, SummaryTable::GradeB>(row);
+        r.gradeCounts[2] = field<Q, SummaryTable::GradeC>(row);
+        r.gradeCounts[3] = field<Q, SummaryTable::GradeD>(row);
+        r.gradeCounts[4] = field<Q, SummaryTable::GradeF>(row);
+        r.totalPaid = field<Q, SummaryTable::TotalPaid>(row);
+        r.lastPaidOn = field<Q, SummaryTable::LastPaidOn>(row);
+    });
+    return rankings;
+}
+
 // Student Methods
 void Student::viewProfile() {
     cout << "\n=== Student Profile ===" << endl;
@@ -246,7 +468,12 @@ void Student::viewFeeReceipts(DBManager& db) {
 
 // Admin Methods
 void Admin::viewAllStudents(DBManager& db) {
-    vector<Student> students = db.getAllStudents();
+    StudentList list;
+    if (!db.getAllStudents(list)) {
+        cout << "Failed to load students." << endl;
+        return;
+    }
+    const auto& students = list.students;
     cout << "\n=== All Students ===" << endl;
     if (students.empty()) {
         cout << "No students found." << endl;
@@ -261,11 +488,15 @@ void Admin::viewAllStudents(DBManager& db) {
 }
 
 void Admin::searchStudents(DBManager& db, string key, string value) {
-    vector<Student> students = db.getAllStudents();
+    StudentList list;
+    if (!db.getAllStudents(list)) {
+        cout << "Failed to load students." << endl;
+        return;
+    }
     cout << "\n=== Search Results (" << key << " = " << value << ") ===" << endl;
     bool found = false;
-    for (const auto& s : students) {
-        if ((key == "department" && s.department == value) ||
+    for (const auto& s : list.students) {
+        if ((key == "department" && string_view(s.department) == value) ||
             (key == "year" && to_string(s.year) == value) ||
             (key == "name" && s.name.find(value) != string::npos)) {
             cout << s.studentID << " - " << s.name << " (" << s.department << ", Year " << s.year << ")\n";
@@ -299,18 +530,12 @@ void Admin::addStudent(DBManager& db) {
     cout << "Fee Status (Paid/Pending/Overdue): "; getline(cin, s.feeStatus);
     cout << "Password: "; getline(cin, s.password);
 
-    string escapedID = escapeString(db.conn, s.studentID);
-    string escapedName = escapeString(db.conn, s.name);
-    string escapedDept = escapeString(db.conn, s.department);
-    string escapedContact = escapeString(db.conn, s.contact);
-    string escapedRecord = escapeString(db.conn, s.academicRecord);
-    string escapedStatus = escapeString(db.conn, s.feeStatus);
-    string escapedPass = escapeString(db.conn, s.password);
-
-    string query = "INSERT INTO Students (StudentID, Name, Department, Year, Contact, AcademicRecord, FeeStatus, Password) VALUES ('" +
-                   escapedID + "', '" + escapedName + "', '" + escapedDept + "', " + to_string(s.year) + 
-                   ", '" + escapedContact + "', '" + escapedRecord + "', '" + escapedStatus + "', '" + escapedPass + "')";
-    if (db.executeQuery(query)) {
+    string query = insertQuery<StudentInsert>(db.conn, s.studentID, s.name, s.department, s.year,
+                                              s.contact, s.academicRecord, s.feeStatus, s.password);
+    bool ok = db.runInTransaction([&] {
+        return db.executeQuery(query) && db.refreshStudentSummary(s.studentID);
+    });
+    if (ok) {
         cout << "Student added successfully!" << endl;
     } else {
         cout << "Failed to add student (ID may already exist)." << endl;
@@ -326,6 +551,7 @@ void Admin::updateStudent(DBManager& db, string studentID) {
     cout << "\n=== Update Student (Current: " << s.name << ") ===" << endl;
     cout << "Leave blank to keep current value.\n";
     string input;
+    string oldDepartment = s.department;
     cin.ignore(numeric_limits<streamsize>::max(), '\n');  // Clear buffer
     cout << "Name (" << s.name << "): "; getline(cin, input); if (!input.empty()) s.name = input;
     cout << "Department (" << s.department << "): "; getline(cin, input); if (!input.empty()) s.department = input;
@@ -340,18 +566,13 @@ void Admin::updateStudent(DBManager& db, string studentID) {
     cout << "Academic Record (" << s.academicRecord << "): "; getline(cin, input); if (!input.empty()) s.academicRecord = input;
     cout << "Fee Status (" << s.feeStatus << "): "; getline(cin, input); if (!input.empty()) s.feeStatus = input;
 
-    string escapedID = escapeString(db.conn, s.studentID);
-    string escapedName = escapeString(db.conn, s.name);
-    string escapedDept = escapeString(db.conn, s.department);
-    string escapedContact = escapeString(db.conn, s.contact);
-    string escapedRecord = escapeString(db.conn, s.academicRecord);
-    string escapedStatus = escapeString(db.conn, s.feeStatus);
-
-    string query = "UPDATE Students SET Name='" + escapedName + "', Department='" + escapedDept + 
-                   "', Year=" + to_string(s.year) + ", Contact='" + escapedContact + 
-                   "', AcademicRecord='" + escapedRecord + "', FeeStatus='" + escapedStatus + 
-                   "' WHERE StudentID='" + escapedID + "'";
-    if (db.executeQuery(query)) {
+    string query = updateQuery<StudentUpdate>(db.conn, whereEquals<StudentsTable::StudentID>(db.conn, s.studentID),
+                                              s.name, s.department, s.year, s.contact, s.academicRecord, s.feeStatus);
+    bool ok = db.runInTransaction([&] {
+        return db.executeQuery(query) && db.refreshStudentSummary(s.studentID) &&
+               (oldDepartment == s.department || db.rankDepartment(oldDepartment));
+    });
+    if (ok) {
         cout << "Student updated successfully!" << endl;
     } else {
         cout << "Failed to update student." << endl;
@@ -370,12 +591,20 @@ void Admin::deleteStudent(DBManager& db, string studentID) {
     cin >> confirm;
     cin.ignore(numeric_limits<streamsize>::max(), '\n');  // Clear buffer
     if (confirm == 'y' || confirm == 'Y') {
-        string escapedID = escapeString(db.conn, studentID);
         // Delete related marks and receipts first (cascade)
-        string delMarks = "DELETE FROM Marksheets WHERE StudentID='" + escapedID + "'";
-        string delReceipts = "DELETE FROM FeeReceipts WHERE StudentID='" + escapedID + "'";
-        string delStudent = "DELETE FROM Students WHERE StudentID='" + escapedID + "'";
-        if (db.executeQuery(delMarks) && db.executeQuery(delReceipts) && db.executeQuery(delStudent)) {
+        string delMarks =
+            schema::Delete<MarksTable>::sql(whereEquals<MarksTable::StudentID>(db.conn, studentID));
+        string delReceipts =
+            schema::Delete<ReceiptsTable>::sql(whereEquals<ReceiptsTable::StudentID>(db.conn, studentID));
+        string delSummary =
+            schema::Delete<SummaryTable>::sql(whereEquals<SummaryTable::StudentID>(db.conn, studentID));
+        string delStudent =
+            schema::Delete<StudentsTable>::sql(whereEquals<StudentsTable::StudentID>(db.conn, studentID));
+        bool ok = db.runInTransaction([&] {
+            return db.executeQuery(delMarks) && db.executeQuery(delReceipts) && db.executeQuery(delSummary) &&
+                   db.executeQuery(delStudent) && db.rankDepartment(s.department);
+        });
+        if (ok) {
             cout << "Student deleted successfully!" << endl;
         } else {
             cout << "Failed to delete student." << endl;
@@ -421,12 +650,9 @@ void Admin::updateMarks(DBManager& db, string studentID) {
     else if (marks >= 60) grade = "D";
     else grade = "F";
 
-    string escapedID = escapeString(db.conn, studentID);
-    string escapedSubject = escapeString(db.conn, subject);
-    string escapedGrade = escapeString(db.conn, grade);
-
     // Check if subject exists; update or insert
-    string checkQuery = "SELECT * FROM Marksheets WHERE StudentID='" + escapedID + "' AND Subject='" + escapedSubject + "'";
+    string markWhere = whereEquals<MarksTable::StudentID, MarksTable::Subject>(db.conn, studentID, subject);
+    string checkQuery = MarkExistsQuery::sql(markWhere);
     if (mysql_query(db.conn, checkQuery.c_str()) != 0) {
         cout << "Query Error: " << mysql_error(db.conn) << endl;
         return;
@@ -437,15 +663,16 @@ void Admin::updateMarks(DBManager& db, string studentID) {
 
     string query;
     if (exists) {
-        query = "UPDATE Marksheets SET Marks=" + to_string(marks) + ", Grade='" + escapedGrade + 
-                "' WHERE StudentID='" + escapedID + "' AND Subject='" + escapedSubject + "'";
+        query = updateQuery<MarksUpdate>(db.conn, markWhere, marks, grade);
         cout << "Marks updated for " << subject << "." << endl;
     } else {
-        query = "INSERT INTO Marksheets (StudentID, Subject, Marks, Grade) VALUES ('" + escapedID + 
-                "', '" + escapedSubject + "', " + to_string(marks) + ", '" + escapedGrade + "')";
+        query = insertQuery<MarksInsert>(db.conn, studentID, subject, marks, grade);
         cout << "Marks added for " << subject << "." << endl;
     }
-    if (db.executeQuery(query)) {
+    bool ok = db.runInTransaction([&] {
+        return db.executeQuery(query) && db.refreshStudentSummary(studentID);
+    });
+    if (ok) {
         cout << "Operation successful! Grade: " << grade << endl;
     } else {
         cout << "Failed to update/add marks." << endl;
@@ -486,28 +713,55 @@ void Admin::addFeeReceipt(DBManager& db, string studentID) {
     string status;
     getline(cin, status);
 
-    string escapedID = escapeString(db.conn, studentID);
-    string escapedReceiptID = escapeString(db.conn, receiptID);
-    string escapedPaidOn = escapeString(db.conn, paidOn);
-    string escapedDetails = escapeString(db.conn, details);
-    string escapedStatus = escapeString(db.conn, status);
-
-    string query = "INSERT INTO FeeReceipts (ReceiptID, StudentID, Amount, PaidOn, TransactionDetails, Status) VALUES ('" +
-                   escapedReceiptID + "', '" + escapedID + "', " + to_string(amount) + 
-                   ", '" + escapedPaidOn + "', '" + escapedDetails + "', '" + escapedStatus + "')";
-    if (db.executeQuery(query)) {
+    string query = insertQuery<ReceiptInsert>(db.conn, receiptID, studentID, amount, paidOn, details, status);
+    // Update fee status to Paid if this is a full payment (simple logic)
+    string updateStatus = updateQuery<FeeStatusUpdate>(
+        db.conn, whereEquals<StudentsTable::StudentID>(db.conn, studentID), status);
+    bool ok = db.runInTransaction([&] {
+        return db.executeQuery(query) && (status != "Paid" || db.executeQuery(updateStatus)) &&
+               db.refreshStudentSummary(studentID);
+    });
+    if (ok) {
         cout << "Fee receipt added successfully!" << endl;
-        // Update fee status to Paid if this is a full payment (simple logic)
-        if (status == "Paid") {
-            string updateStatus = "UPDATE Students SET FeeStatus='Paid' WHERE StudentID='" + escapedID + "'";
-            db.executeQuery(updateStatus);
-            cout << "Student fee status updated to Paid." << endl;
-        }
+        if (status == "Paid") cout << "Student fee status updated to Paid." << endl;
     } else {
         cout << "Failed to add fee receipt (ID may already exist)." << endl;
     }
 }
 
+void Admin::viewClassRankings(DBManager& db) {
+    cout << "Department (blank for all): ";
+    string department;
+    getline(cin, department);
+    if (!db.ensureStudentSummaries()) {
+        cout << "Failed to bring student summaries up to date." << endl;
+        return;
+    }
+    vector<StudentSummary> rankings = db.getClassRankings(department);
+    cout << "\n=== Class Rankings ===" << endl;
+    if (rankings.empty()) {
+        cout << "No summaries found." << endl;
+        return;
+    }
+    cout << left << setw(25) << "Department" << setw(6) << "Rank" << setw(12) << "StudentID" << setw(10) << "AvgMarks"
+         << setw(10) << "Subjects" << setw(16) << "A/B/C/D/F" << setw(12) << "TotalPaid" << "LastPaidOn" << endl;
+    for (const auto& r : rankings) {
+        string grades = to_string(r.gradeCounts[0]) + "/" + to_string(r.gradeCounts[1]) + "/" + to_string(r.gradeCounts[2]) +
+                        "/" + to_string(r.gradeCounts[3]) + "/" + to_string(r.gradeCounts[4]);
+        cout << left << setw(25) << r.department << setw(6) << r.deptRank << setw(12) << r.studentID
+             << setw(10) << fixed << setprecision(2) << r.avgMarks << setw(10) << r.subjectCount << setw(16) << grades
+             << setw(12) << r.totalPaid << (r.lastPaidOn.empty() ? "-" : r.lastPaidOn) << endl;
+    }
+}
+
+void Admin::rebuildSummaries(DBManager& db) {
+    if (db.rebuildStudentSummaries()) {
+        cout << "Student summaries rebuilt successfully!" << endl;
+    } else {
+        cout << "Failed to rebuild student summaries." << endl;
+    }
+}
+
 // Main function with login and menu loops
 int main(int argc, char* argv[]) {
     // Create Qt application (required for dialog)
@@ -545,7 +799,7 @@ int main(int argc, char* argv[]) {
         if (isAdmin) {
             // Admin Menu
             cout << "\n=== Admin Menu ===" << endl;
-            cout << "1. View All Students\n2. Search Students\n3. Add Student\n4. Update Student\n5. Delete Student\n6. Update Marks\n7. Add Fee Receipt\n8. Logout\nChoice: ";
+            cout << "1. View All Students\n2. Search Students\n3. Add Student\n4. Update Student\n5. Delete Student\n6. Update Marks\n7. Add Fee Receipt\n8. Class Rankings\n9. Rebuild Student Summaries\n10. Logout\nChoice: ";
             int adminChoice;
             cin >> adminChoice;
             cin.ignore(numeric_limits<streamsize>::max(), '\n');
@@ -580,7 +834,9 @@ int main(int argc, char* argv[]) {
                     admin.addFeeReceipt(db, tempID);
                     break;
                 }
-                case 8: {
+                case 8: admin.viewClassRankings(db); break;
+                case 9: admin.rebuildSummaries(db); break;
+                case 10: {
                     loggedIn = false;
                     cout << "Logged out." << endl;
                     break;
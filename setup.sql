@@ -1,7 +1,7 @@
 -- =============================================
 -- College Student Office DBMS Setup Script
 -- Database: bvp_student_office
--- Tables: Students, Admins, Marksheets, FeeReceipts
+-- Tables: Students, Admins, Marksheets, FeeReceipts, StudentSummary
 -- Sample Data Included for Testing
 -- =============================================
 
@@ -10,6 +10,7 @@ CREATE DATABASE IF NOT EXISTS bvp_student_office;
 USE bvp_student_office;
 
 -- Drop tables if they exist (for clean setup; comment out if you want to preserve data)
+DROP TABLE IF EXISTS StudentSummary;
 DROP TABLE IF EXISTS FeeReceipts;
 DROP TABLE IF EXISTS Marksheets;
 DROP TABLE IF EXISTS Students;
@@ -61,6 +62,28 @@ CREATE TABLE FeeReceipts (
     FOREIGN KEY (StudentID) REFERENCES Students(StudentID) ON DELETE CASCADE
 ) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
 
+-- Create StudentSummary Table
+-- One narrow row per student for rankings and dashboards.
+-- Kept current by the application in the same transaction as every marks,
+-- receipt and student write; "Rebuild Student Summaries" in the admin menu
+-- recomputes it from scratch (needs MySQL 8.0 for RANK() OVER).
+CREATE TABLE StudentSummary (
+    StudentID VARCHAR(20) PRIMARY KEY,
+    Department VARCHAR(50) NOT NULL,
+    AvgMarks DECIMAL(5, 2) NOT NULL DEFAULT 0,
+    SubjectCount INT NOT NULL DEFAULT 0,
+    GradeA INT NOT NULL DEFAULT 0,
+    GradeB INT NOT NULL DEFAULT 0,
+    GradeC INT NOT NULL DEFAULT 0,
+    GradeD INT NOT NULL DEFAULT 0,
+    GradeF INT NOT NULL DEFAULT 0,
+    TotalPaid DECIMAL(12, 2) NOT NULL DEFAULT 0,
+    LastPaidOn DATE NULL,
+    DeptRank INT NOT NULL DEFAULT 0,
+    INDEX idx_summary_rank (Department, DeptRank),
+    FOREIGN KEY (StudentID) REFERENCES Students(StudentID) ON DELETE CASCADE
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
 -- =============================================
 -- Insert Sample Data for Testing
 -- =============================================
@@ -89,6 +112,9 @@ INSERT INTO Marksheets (StudentID, Subject, Marks, Grade) VALUES
 INSERT INTO FeeReceipts (ReceiptID, StudentID, Amount, PaidOn, TransactionDetails, Status) VALUES
 ('REC001', 'STU001', 5000.00, '2023-09-01', 'Annual Tuition Fee Payment via Online Banking', 'Paid');
 
+-- StudentSummary is left empty here so its SQL lives only in the application,
+-- which fills in any missing rows the first time Class Rankings is opened.
+
 -- =============================================
 -- Verification Queries (Run these to test)
 -- =============================================
@@ -96,6 +122,7 @@ INSERT INTO FeeReceipts (ReceiptID, StudentID, Amount, PaidOn, TransactionDetail
 -- SELECT * FROM Students;
 -- SELECT * FROM Marksheets WHERE StudentID = 'STU001';
 -- SELECT * FROM FeeReceipts WHERE StudentID = 'STU001';
+-- SELECT * FROM StudentSummary ORDER BY Department, DeptRank;
 
 -- Success Message
 SELECT 'Database setup completed successfully! Tables created with sample data.' AS Status;
@@ -0,0 +1,76 @@
+#pragma once
+
+// In-memory stand-in for the parts of the MySQL C API used by RowView.h, so
+// decoding tests build without a server or client library. A MYSQL handle
+// answers each query through its `handler` (queries containing a non-empty
+// `failOn` fail instead); result sets are fully
+// materialized in mysql_store_result, which flags its own allocations via
+// fake_mysql_internal so allocation-counting tests can leave them out.
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+typedef char** MYSQL_ROW;
+typedef unsigned long long my_ulonglong;
+
+inline bool fake_mysql_internal = false;
+
+struct MYSQL {
+  std::function<std::vector<std::vector<std::string>>(const std::string&)> handler;
+  std::string failOn;
+  std::string lastQuery;
+};
+
+struct MYSQL_RES {
+  std::vector<std::vector<std::string>> rows;
+  std::vector<std::vector<char*>> fields;
+  std::vector<std::vector<unsigned long>> lengths;
+  std::size_t next = 0;
+};
+
+inline int mysql_query(MYSQL* conn, const char* query) {
+  fake_mysql_internal = true;
+  conn->lastQuery = query;
+  fake_mysql_internal = false;
+  return !conn->failOn.empty() && conn->lastQuery.find(conn->failOn) != std::string::npos;
+}
+
+inline const char* mysql_error(MYSQL*) { return "fake query failure"; }
+
+inline MYSQL_RES* mysql_store_result(MYSQL* conn) {
+  fake_mysql_internal = true;
+  MYSQL_RES* res = new MYSQL_RES;
+  res->rows = conn->handler(conn->lastQuery);
+  for (auto& row : res->rows) {
+    std::vector<char*> fields;
+    std::vector<unsigned long> lengths;
+    for (auto& value : row) {
+      fields.push_back(value.data());
+      lengths.push_back(static_cast<unsigned long>(value.size()));
+    }
+    res->fields.push_back(std::move(fields));
+    res->lengths.push_back(std::move(lengths));
+  }
+  fake_mysql_internal = false;
+  return res;
+}
+
+inline my_ulonglong mysql_num_rows(MYSQL_RES* res) { return res->rows.size(); }
+
+inline MYSQL_ROW mysql_fetch_row(MYSQL_RES* res) {
+  if (res->next >= res->rows.size()) return nullptr;
+  return res->fields[res->next++].data();
+}
+
+inline unsigned long* mysql_fetch_lengths(MYSQL_RES* res) { return res->lengths[res->next - 1].data(); }
+
+inline void mysql_free_result(MYSQL_RES* res) { delete res; }
+
+inline unsigned long mysql_real_escape_string(MYSQL*, char* to, const char* from, unsigned long length) {
+  std::memcpy(to, from, length);
+  to[length] = '\0';
+  return length;
+}
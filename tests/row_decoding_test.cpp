@@ -0,0 +1,255 @@
+// Allocation counts for loading every student with marks and receipts: the
+// original per-student path (SELECT per student, copied MYSQL_ROW strings,
+// atoi/atof, push_back copies) against loadAllStudents from StudentList.h, which
+// DBManager::getAllStudents calls. Runs on the fake client in tests/fake_mysql.
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "StudentList.h"
+
+using namespace std;
+
+static size_t allocationCount = 0;
+static bool counting = false;
+
+// Counts allocations while `counting` is set. GCC flags the malloc/free pair
+// behind a replaced operator new/delete as mismatched once both are inlined.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void* operator new(size_t size) {
+  if (counting && !fake_mysql_internal) ++allocationCount;
+  void* p = malloc(size ? size : 1);
+  if (!p) throw bad_alloc();
+  return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+struct Student {
+  string studentID, name, department, contact, feeStatus;
+  int year = 0;
+  vector<pair<string, pair<int, string>>> marks;
+  vector<tuple<string, double, string, string, string>> receipts;
+};
+
+// Fixture: kStudents students with kMarks marks and kReceipts receipts each
+constexpr int kStudents = 200;
+constexpr int kMarks = 6;
+constexpr int kReceipts = 3;
+
+using Rows = vector<vector<string>>;
+
+string studentID(int i) { return "STU" + to_string(1000 + i); }
+
+Rows studentRows() {
+  Rows rows;
+  for (int i = 0; i < kStudents; ++i) {
+    rows.push_back({studentID(i), "Student Number " + to_string(i), "Computer Science and Engineering",
+                    to_string(1 + i % 4), "student" + to_string(i) + "@college.example.edu", "Pending"});
+  }
+  return rows;
+}
+
+Rows markRows(const string& onlyID) {
+  Rows rows;
+  for (int i = 0; i < kStudents; ++i) {
+    if (!onlyID.empty() && studentID(i) != onlyID) continue;
+    for (int m = 0; m < kMarks; ++m) {
+      Rows::value_type row = {studentID(i), "Subject " + to_string(m), to_string(50 + (i + m) % 50), "B"};
+      if (!onlyID.empty()) row.erase(row.begin());
+      rows.push_back(move(row));
+    }
+  }
+  return rows;
+}
+
+Rows receiptRows(const string& onlyID) {
+  Rows rows;
+  for (int i = 0; i < kStudents; ++i) {
+    if (!onlyID.empty() && studentID(i) != onlyID) continue;
+    for (int r = 0; r < kReceipts; ++r) {
+      Rows::value_type row = {studentID(i), "REC" + to_string(i * kReceipts + r), "5000.50", "2023-09-01",
+                              "Semester tuition fee payment via online banking", "Paid"};
+      if (!onlyID.empty()) row.erase(row.begin());
+      rows.push_back(move(row));
+    }
+  }
+  return rows;
+}
+
+Rows answer(const string& query) {
+  string onlyID;
+  size_t where = query.find("StudentID='");
+  if (where != string::npos) onlyID = query.substr(where + 11, query.find('\'', where + 11) - where - 11);
+  if (query.find("FROM Students") != string::npos) return studentRows();
+  if (query.find("FROM Marksheets") != string::npos) return markRows(onlyID);
+  return receiptRows(onlyID);
+}
+
+// --- Original path, as DBManager did it before RowView ---
+
+string escapeString(MYSQL* conn, const string& str) {
+  char* escaped = new char[str.length() * 2 + 1];
+  unsigned long escaped_len = mysql_real_escape_string(conn, escaped, str.c_str(), str.length());
+  string result(escaped, escaped_len);
+  delete[] escaped;
+  return result;
+}
+
+vector<pair<string, pair<int, string>>> legacyMarksheet(MYSQL* conn, string studentID) {
+  vector<pair<string, pair<int, string>>> marks;
+  string escapedID = escapeString(conn, studentID);
+  string query = "SELECT Subject, Marks, Grade FROM Marksheets WHERE StudentID='" + escapedID + "'";
+  if (mysql_query(conn, query.c_str()) != 0) return marks;
+  MYSQL_RES* res = mysql_store_result(conn);
+  MYSQL_ROW row;
+  while ((row = mysql_fetch_row(res))) {
+    string subject = row[0] ? row[0] : "";
+    int marksInt = row[1] ? atoi(row[1]) : 0;
+    string grade = row[2] ? row[2] : "";
+    marks.push_back({subject, {marksInt, grade}});
+  }
+  if (res) mysql_free_result(res);
+  return marks;
+}
+
+vector<tuple<string, double, string, string, string>> legacyFeeReceipts(MYSQL* conn, string studentID) {
+  vector<tuple<string, double, string, string, string>> receipts;
+  string escapedID = escapeString(conn, studentID);
+  string query = "SELECT ReceiptID, Amount, PaidOn, TransactionDetails, Status FROM FeeReceipts WHERE StudentID='" +
+                 escapedID + "'";
+  if (mysql_query(conn, query.c_str()) != 0) return receipts;
+  MYSQL_RES* res = mysql_store_result(conn);
+  MYSQL_ROW row;
+  while ((row = mysql_fetch_row(res))) {
+    string id = row[0] ? row[0] : "";
+    double amount = row[1] ? atof(row[1]) : 0.0;
+    string date = row[2] ? row[2] : "";
+    string details = row[3] ? row[3] : "";
+    string status = row[4] ? row[4] : "";
+    receipts.push_back(make_tuple(id, amount, date, details, status));
+  }
+  if (res) mysql_free_result(res);
+  return receipts;
+}
+
+vector<Student> legacyLoad(MYSQL* conn) {
+  vector<Student> students;
+  string query = "SELECT StudentID, Name, Department, Year, Contact, FeeStatus FROM Students";
+  if (mysql_query(conn, query.c_str()) != 0) return students;
+  MYSQL_RES* res = mysql_store_result(conn);
+  MYSQL_ROW row;
+  while ((row = mysql_fetch_row(res))) {
+    Student s;
+    s.studentID = row[0] ? row[0] : "";
+    s.name = row[1] ? row[1] : "";
+    s.department = row[2] ? row[2] : "";
+    s.year = row[3] ? atoi(row[3]) : 0;
+    s.contact = row[4] ? row[4] : "";
+    s.feeStatus = row[5] ? row[5] : "";
+    s.marks = legacyMarksheet(conn, s.studentID);
+    s.receipts = legacyFeeReceipts(conn, s.studentID);
+    students.push_back(s);
+  }
+  if (res) mysql_free_result(res);
+  return students;
+}
+
+// loadAllStudents keeps every row in the list's arena; it must need at least an
+// order of magnitude fewer heap allocations than the per-student path
+constexpr size_t kMinReduction = 10;
+
+bool sameStudents(const vector<Student>& a, const StudentList& list) {
+  const auto& b = list.students;
+  if (a.size() != b.size()) return false;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if (a[i].studentID != string_view(b[i].studentID) || a[i].name != string_view(b[i].name) ||
+        a[i].department != string_view(b[i].department) || a[i].year != b[i].year ||
+        a[i].contact != string_view(b[i].contact) || a[i].feeStatus != string_view(b[i].feeStatus) ||
+        a[i].marks.size() != b[i].marks.size() || a[i].receipts.size() != b[i].receipts.size()) {
+      return false;
+    }
+    for (size_t m = 0; m < a[i].marks.size(); ++m) {
+      const auto& mark = b[i].marks[m];
+      if (a[i].marks[m] != make_pair(string(mark.subject), make_pair(mark.marks, string(mark.grade)))) return false;
+    }
+    for (size_t r = 0; r < a[i].receipts.size(); ++r) {
+      const auto& receipt = b[i].receipts[r];
+      if (a[i].receipts[r] != make_tuple(string(receipt.receiptID), receipt.amount, string(receipt.paidOn),
+                                         string(receipt.details), string(receipt.status))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int main() {
+  int failures = 0;
+
+  // RowView: NULL fields, lengths not relying on NUL terminators, from_chars parsing
+  {
+    char id[] = "STU001xyz";
+    char year[] = "3";
+    char amount[] = "5000.25";
+    char* fields[] = {id, nullptr, year, amount};
+    unsigned long lengths[] = {6, 0, 1, 7};
+    RowView row(fields, lengths);
+    if (row.str(0) != "STU001" || !row.str(1).empty() || row.toInt(1) != 0 || row.as<int>(2) != 3 ||
+        row.as<double>(3) != 5000.25) {
+      cout << "FAIL: RowView decoding" << endl;
+      ++failures;
+    }
+  }
+
+  MYSQL conn;
+  conn.handler = answer;
+
+  allocationCount = 0;
+  counting = true;
+  vector<Student> legacy = legacyLoad(&conn);
+  counting = false;
+  size_t legacyAllocations = allocationCount;
+
+  allocationCount = 0;
+  counting = true;
+  StudentList loaded;
+  bool ok = loadAllStudents(&conn, loaded);
+  counting = false;
+  size_t loadedAllocations = allocationCount;
+
+  cout << "Students: " << kStudents << " (" << kMarks << " marks, " << kReceipts << " receipts each)" << endl;
+  cout << "Per-student load allocations: " << legacyAllocations << endl;
+  cout << "loadAllStudents allocations:  " << loadedAllocations << endl;
+  cout << "Reduction: " << (loadedAllocations ? double(legacyAllocations) / loadedAllocations : 0.0) << "x" << endl;
+
+  if (!ok || legacy.size() != size_t(kStudents) || !sameStudents(legacy, loaded)) {
+    cout << "FAIL: loadAllStudents does not match the per-student load" << endl;
+    ++failures;
+  }
+  if (loadedAllocations * kMinReduction > legacyAllocations) {
+    cout << "FAIL: loadAllStudents allocates less than " << kMinReduction << "x below the per-student load" << endl;
+    ++failures;
+  }
+
+  // A failing query is reported, not mistaken for an empty result
+  {
+    MYSQL failing;
+    failing.handler = answer;
+    failing.failOn = "FROM FeeReceipts";
+    StudentList partial;
+    if (loadAllStudents(&failing, partial)) {
+      cout << "FAIL: loadAllStudents ignored a failed receipts query" << endl;
+      ++failures;
+    }
+  }
+  return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}